@@ -0,0 +1,311 @@
+#include "BuildCostAnalyzer.hpp"
+#include "../utils/Json.hpp"
+#include "../utils/Paths.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+using namespace DragonEyes;
+
+namespace {
+
+    // Nombre de lignes affichees par section dans le rapport texte
+    constexpr size_t kTextRows = 30;
+
+    struct Inclusion {
+        CXFile file;
+        std::string path;
+        std::string top;  // #include de la TU par lequel le fichier arrive
+    };
+
+}
+
+BuildCostAnalyzer::BuildCostAnalyzer(const std::vector<std::string>& args) {
+    index_ = clang_createIndex(0, 0);
+    for (auto& a : args)
+        clangArgs_.push_back(a.c_str());
+}
+
+BuildCostAnalyzer::~BuildCostAnalyzer() {
+    clang_disposeIndex(index_);
+}
+
+void BuildCostAnalyzer::analyzeFile(const SourceFile& f) {
+    if (!f.exists || !isTranslationUnit(f.path)) return;
+
+    auto start = std::chrono::steady_clock::now();
+    CXTranslationUnit tu = clang_parseTranslationUnit(
+        index_,
+        f.path.c_str(),
+        clangArgs_.data(),
+        static_cast<int>(clangArgs_.size()),
+        nullptr, 0,
+        CXTranslationUnit_DetailedPreprocessingRecord
+    );
+    double parseMs = std::chrono::duration<double, std::milli>(
+        std::chrono::steady_clock::now() - start).count();
+    if (!tu) {
+        std::cerr << "Echec de l'analyse de " << f.path << "\n";
+        return;
+    }
+
+    // 1) en-tetes de la TU et #include direct dont ils proviennent
+    std::vector<Inclusion> inclusions;
+    clang_getInclusions(tu, [](CXFile included, CXSourceLocation* stack, unsigned len, CXClientData data) {
+        if (len == 0) return; // fichier principal
+        auto* list = reinterpret_cast<std::vector<Inclusion>*>(data);
+        Inclusion inc;
+        inc.file = included;
+        inc.path = fileName(included);
+        if (len == 1) {
+            inc.top = inc.path;
+        } else {
+            // stack[len - 1] est dans la TU, stack[len - 2] dans l'en-tete qu'elle inclut
+            CXFile topFile = nullptr;
+            clang_getSpellingLocation(stack[len - 2], &topFile, nullptr, nullptr, nullptr);
+            inc.top = fileName(topFile);
+        }
+        list->push_back(std::move(inc));
+    }, &inclusions);
+
+    std::unordered_map<std::string, std::string> topOf;
+    std::unordered_map<std::string, uint64_t> tokensByTop;
+    uint64_t totalTokens = countTokens(tu, clang_getFile(tu, f.path.c_str()), fs::path(f.path).lexically_normal().string());
+    for (auto& inc : inclusions) {
+        if (!topOf.emplace(inc.path, inc.top).second)
+            continue; // en-tete sans garde, deja compte pour cette TU
+        uint64_t tokens = countTokens(tu, inc.file, inc.path);
+        tokensByTop[inc.top] += tokens;
+        totalTokens += tokens;
+    }
+
+    for (auto& [path, top] : topOf) {
+        HeaderStats& stats = headers_[path];
+        stats.inclusionCount++;
+        stats.cumulativeParseMs += parseMs;
+        if (totalTokens > 0)
+            stats.attributedParseMs += parseMs * static_cast<double>(tokenCounts_[path]) / totalTokens;
+    }
+
+    // 2) fichiers dont la TU utilise une declaration ou une macro
+    std::unordered_set<std::string> usedFiles;
+    CXCursor rootCursor = clang_getTranslationUnitCursor(tu);
+    clang_visitChildren(rootCursor, [](CXCursor c, CXCursor, CXClientData data) {
+        if (!clang_Location_isFromMainFile(clang_getCursorLocation(c)))
+            return CXChildVisit_Continue;
+        auto* used = reinterpret_cast<std::unordered_set<std::string>*>(data);
+        // reference (type, appel, macro...) ou redeclaration d'un symbole d'en-tete
+        for (CXCursor target : { clang_getCursorReferenced(c), clang_getCanonicalCursor(c) }) {
+            if (clang_Cursor_isNull(target) || clang_equalCursors(target, c))
+                continue;
+            CXFile file = nullptr;
+            clang_getSpellingLocation(clang_getCursorLocation(target), &file, nullptr, nullptr, nullptr);
+            if (file)
+                used->insert(fileName(file));
+        }
+        return CXChildVisit_Recurse;
+    }, &usedFiles);
+
+    // macros definies dans les en-tetes, pour leurs usages en #if / #ifdef
+    std::unordered_map<std::string, std::string> macroFiles;
+    clang_visitChildren(rootCursor, [](CXCursor c, CXCursor, CXClientData data) {
+        if (clang_getCursorKind(c) != CXCursor_MacroDefinition
+            || clang_Location_isFromMainFile(clang_getCursorLocation(c)))
+            return CXChildVisit_Continue;
+        CXFile file = nullptr;
+        clang_getSpellingLocation(clang_getCursorLocation(c), &file, nullptr, nullptr, nullptr);
+        if (file)
+            reinterpret_cast<std::unordered_map<std::string, std::string>*>(data)->emplace(
+                toString(clang_getCursorSpelling(c)), fileName(file));
+        return CXChildVisit_Continue;
+    }, &macroFiles);
+    markConditionalMacroUses(tu, clang_getFile(tu, f.path.c_str()), f.path, macroFiles, usedFiles);
+
+    std::unordered_set<std::string> usedTops;
+    for (auto& path : usedFiles) {
+        auto it = topOf.find(path);
+        if (it != topOf.end())
+            usedTops.insert(it->second);
+    }
+    for (auto& [top, tokens] : tokensByTop) {
+        if (usedTops.count(top))
+            continue;
+        UnusedInclude unused;
+        unused.includer = f.path;
+        unused.header = top;
+        unused.transitiveTokens = tokens;
+        unused.estimatedParseMs = totalTokens > 0 ? parseMs * static_cast<double>(tokens) / totalTokens : 0.0;
+        unusedIncludes_.push_back(std::move(unused));
+    }
+
+    translationUnits_++;
+    totalParseMs_ += parseMs;
+    clang_disposeTranslationUnit(tu);
+}
+
+// Un #if, #ifdef ou defined() ne produit aucun curseur de reference : on
+// relit les directives conditionnelles de la TU et on retrouve les macros
+// d'en-tete qu'elles nomment.
+void BuildCostAnalyzer::markConditionalMacroUses(CXTranslationUnit tu, CXFile mainFile, const std::string& mainPath,
+                                                 const std::unordered_map<std::string, std::string>& macroFiles,
+                                                 std::unordered_set<std::string>& usedFiles) {
+    std::error_code ec;
+    auto size = fs::file_size(mainPath, ec);
+    if (!mainFile || ec || macroFiles.empty())
+        return;
+
+    CXSourceRange range = clang_getRange(
+        clang_getLocationForOffset(tu, mainFile, 0),
+        clang_getLocationForOffset(tu, mainFile, static_cast<unsigned>(size))
+    );
+    CXToken* tokens = nullptr;
+    unsigned numTokens = 0;
+    clang_tokenize(tu, range, &tokens, &numTokens);
+
+    auto lineOf = [&](unsigned i) {
+        unsigned line = 0;
+        clang_getSpellingLocation(clang_getTokenLocation(tu, tokens[i]), nullptr, &line, nullptr, nullptr);
+        return line;
+    };
+
+    for (unsigned i = 0; i + 1 < numTokens; ++i) {
+        if (clang_getTokenKind(tokens[i]) != CXToken_Punctuation
+            || toString(clang_getTokenSpelling(tu, tokens[i])) != "#")
+            continue;
+        std::string directive = toString(clang_getTokenSpelling(tu, tokens[i + 1]));
+        if (directive != "if" && directive != "ifdef" && directive != "ifndef"
+            && directive != "elif" && directive != "elifdef" && directive != "elifndef")
+            continue;
+
+        // la directive s'arrete a la fin de sa ligne
+        unsigned line = lineOf(i);
+        for (i += 2; i < numTokens && lineOf(i) == line; ++i) {
+            if (clang_getTokenKind(tokens[i]) != CXToken_Identifier)
+                continue;
+            auto it = macroFiles.find(toString(clang_getTokenSpelling(tu, tokens[i])));
+            if (it != macroFiles.end())
+                usedFiles.insert(it->second);
+        }
+        --i;
+    }
+    clang_disposeTokens(tu, tokens, numTokens);
+}
+
+uint64_t BuildCostAnalyzer::countTokens(CXTranslationUnit tu, CXFile file, const std::string& path) {
+    auto it = tokenCounts_.find(path);
+    if (it != tokenCounts_.end())
+        return it->second;
+
+    uint64_t count = 0;
+    std::error_code ec;
+    auto size = fs::file_size(path, ec);
+    if (file && !ec) {
+        CXSourceRange range = clang_getRange(
+            clang_getLocationForOffset(tu, file, 0),
+            clang_getLocationForOffset(tu, file, static_cast<unsigned>(size))
+        );
+        CXToken* tokens = nullptr;
+        unsigned numTokens = 0;
+        clang_tokenize(tu, range, &tokens, &numTokens);
+        count = numTokens;
+        clang_disposeTokens(tu, tokens, numTokens);
+    }
+    tokenCounts_.emplace(path, count);
+    return count;
+}
+
+BuildCostReport BuildCostAnalyzer::report() const {
+    BuildCostReport r;
+    r.translationUnits = translationUnits_;
+    r.totalParseMs = totalParseMs_;
+
+    for (auto& [path, stats] : headers_) {
+        HeaderCost h;
+        h.path = path;
+        h.inclusionCount = stats.inclusionCount;
+        auto tok = tokenCounts_.find(path);
+        h.tokenCount = tok != tokenCounts_.end() ? tok->second : 0;
+        h.cumulativeTokens = h.tokenCount * h.inclusionCount;
+        h.cumulativeParseMs = stats.cumulativeParseMs;
+        h.attributedParseMs = stats.attributedParseMs;
+        r.headers.push_back(std::move(h));
+    }
+    std::sort(r.headers.begin(), r.headers.end(), [](auto& a, auto& b) {
+        return a.attributedParseMs > b.attributedParseMs;
+    });
+
+    r.unusedIncludes = unusedIncludes_;
+    std::sort(r.unusedIncludes.begin(), r.unusedIncludes.end(), [](auto& a, auto& b) {
+        return a.transitiveTokens > b.transitiveTokens;
+    });
+    return r;
+}
+
+void BuildCostAnalyzer::writeText(const BuildCostReport& report, std::ostream& out) {
+    out << std::fixed << std::setprecision(1);
+    out << "TUs analysees : " << report.translationUnits
+        << " (" << report.totalParseMs << " ms de parsing)\n";
+
+    out << "En-tetes les plus couteux :\n";
+    for (size_t i = 0; i < report.headers.size() && i < kTextRows; ++i) {
+        auto& h = report.headers[i];
+        out << "  - " << h.path << "\n"
+            << "      inclus par " << h.inclusionCount << " TU(s), "
+            << h.tokenCount << " tokens (" << h.cumulativeTokens << " cumules), "
+            << h.attributedParseMs << " ms attribues / "
+            << h.cumulativeParseMs << " ms cumules\n";
+    }
+
+    if (!report.unusedIncludes.empty()) {
+        out << "Includes inutilises les plus couteux :\n";
+        for (size_t i = 0; i < report.unusedIncludes.size() && i < kTextRows; ++i) {
+            auto& u = report.unusedIncludes[i];
+            out << "  - " << u.includer << " -> " << u.header << "\n"
+                << "      " << u.transitiveTokens << " tokens transitifs, ~"
+                << u.estimatedParseMs << " ms\n";
+        }
+    }
+}
+
+void BuildCostAnalyzer::writeJson(const BuildCostReport& report, std::ostream& out) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"translationUnits\":" << report.translationUnits
+        << ",\"totalParseMs\":" << report.totalParseMs
+        << ",\"headers\":[";
+    for (size_t i = 0; i < report.headers.size(); ++i) {
+        auto& h = report.headers[i];
+        out << (i ? "," : "")
+            << "{\"path\":\"" << jsonEscape(h.path)
+            << "\",\"inclusionCount\":" << h.inclusionCount
+            << ",\"tokenCount\":" << h.tokenCount
+            << ",\"cumulativeTokens\":" << h.cumulativeTokens
+            << ",\"cumulativeParseMs\":" << h.cumulativeParseMs
+            << ",\"attributedParseMs\":" << h.attributedParseMs << "}";
+    }
+    out << "],\"unusedIncludes\":[";
+    for (size_t i = 0; i < report.unusedIncludes.size(); ++i) {
+        auto& u = report.unusedIncludes[i];
+        out << (i ? "," : "")
+            << "{\"includer\":\"" << jsonEscape(u.includer)
+            << "\",\"header\":\"" << jsonEscape(u.header)
+            << "\",\"transitiveTokens\":" << u.transitiveTokens
+            << ",\"estimatedParseMs\":" << u.estimatedParseMs << "}";
+    }
+    out << "]}\n";
+}
+
+std::string BuildCostAnalyzer::fileName(CXFile file) {
+    if (!file) return {};
+    return fs::path(toString(clang_getFileName(file))).lexically_normal().string();
+}
+
+std::string BuildCostAnalyzer::toString(CXString s) {
+    std::string str = clang_getCString(s);
+    clang_disposeString(s);
+    return str;
+}
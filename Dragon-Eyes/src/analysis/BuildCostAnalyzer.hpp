@@ -0,0 +1,82 @@
+#ifndef BUILDCOSTANALYZER_HPP
+#define BUILDCOSTANALYZER_HPP
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include <ostream>
+#include <cstdint>
+#include "../data_model/DataModel.hpp"
+#include <clang-c/Index.h>
+
+namespace DragonEyes {
+
+    struct HeaderCost {
+        std::string path;
+        size_t inclusionCount = 0;      // TUs qui l'incluent, directement ou non
+        uint64_t tokenCount = 0;        // tokens du fichier seul
+        uint64_t cumulativeTokens = 0;  // tokens relus sur l'ensemble des TUs
+        double cumulativeParseMs = 0.0; // somme des temps d'analyse des TUs qui l'incluent
+        double attributedParseMs = 0.0; // part de ces temps, au prorata des tokens
+    };
+
+    // #include direct d'une TU dont aucune declaration ou macro n'est utilisee,
+    // y compris dans les #if / #ifdef / defined() de la TU
+    struct UnusedInclude {
+        std::string includer;
+        std::string header;
+        uint64_t transitiveTokens = 0;  // tokens apportes par l'include et ses dependances
+        double estimatedParseMs = 0.0;
+    };
+
+    struct BuildCostReport {
+        size_t translationUnits = 0;
+        double totalParseMs = 0.0;
+        std::vector<HeaderCost> headers;              // par cout attribue decroissant
+        std::vector<UnusedInclude> unusedIncludes;    // par cout decroissant
+    };
+
+    // Mesure le cout de parsing de chaque en-tete en analysant les TUs une a une.
+    class BuildCostAnalyzer {
+    public:
+        BuildCostAnalyzer(const std::vector<std::string>& args);
+        ~BuildCostAnalyzer();
+
+        // Analyse une TU (.c, .cc, .cpp, .cxx) ; les en-tetes sont ignores.
+        void analyzeFile(const SourceFile& f);
+
+        BuildCostReport report() const;
+
+        static void writeText(const BuildCostReport& report, std::ostream& out);
+        static void writeJson(const BuildCostReport& report, std::ostream& out);
+
+    private:
+        struct HeaderStats {
+            size_t inclusionCount = 0;
+            double cumulativeParseMs = 0.0;
+            double attributedParseMs = 0.0;
+        };
+
+        CXIndex index_;
+        std::vector<const char*> clangArgs_;
+
+        size_t translationUnits_ = 0;
+        double totalParseMs_ = 0.0;
+        std::unordered_map<std::string, uint64_t> tokenCounts_;
+        std::unordered_map<std::string, HeaderStats> headers_;
+        std::vector<UnusedInclude> unusedIncludes_;
+
+        uint64_t countTokens(CXTranslationUnit tu, CXFile file, const std::string& path);
+
+        static void markConditionalMacroUses(CXTranslationUnit tu, CXFile mainFile, const std::string& mainPath,
+                                             const std::unordered_map<std::string, std::string>& macroFiles,
+                                             std::unordered_set<std::string>& usedFiles);
+
+        static std::string fileName(CXFile file);
+        static std::string toString(CXString s);
+    };
+
+}
+
+#endif // !BUILDCOSTANALYZER_HPP
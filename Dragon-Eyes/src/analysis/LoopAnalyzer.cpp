@@ -0,0 +1,687 @@
+#include "LoopAnalyzer.hpp"
+#include "../utils/Json.hpp"
+#include "../utils/Paths.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <regex>
+#include <set>
+#include <tuple>
+
+#ifdef _WIN32
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+extern char** environ;
+#endif
+
+namespace fs = std::filesystem;
+using namespace DragonEyes;
+
+namespace {
+
+    struct Token {
+        std::string text;
+        unsigned offset;
+    };
+
+    struct Subscript {
+        std::string base;
+        std::vector<std::string> indices; // une entree par [] , sans espaces
+        bool written = false;
+    };
+
+    // Etat du parcours d'un corps de boucle
+    struct LoopScan {
+        std::vector<Token> tokens;
+        std::vector<Subscript> subscripts;
+        std::set<std::string> calls;
+        std::map<std::string, bool> pointers; // nom -> pointe sur du const
+        std::set<std::string> containers;
+    };
+
+    struct WalkContext {
+        CXTranslationUnit tu;
+        std::string file;
+        std::string function;
+        std::vector<size_t> loopStack;
+        std::vector<LoopReport>* loops;
+    };
+
+    const char* const kNonContiguous[] = {
+        "std::list", "std::forward_list", "std::map", "std::multimap", "std::set",
+        "std::multiset", "std::unordered_map", "std::unordered_set", "std::deque"
+    };
+
+    unsigned offsetOf(CXSourceLocation loc) {
+        unsigned offset = 0;
+        clang_getSpellingLocation(loc, nullptr, nullptr, nullptr, &offset);
+        return offset;
+    }
+
+    std::string spelling(CXString s) {
+        std::string str = clang_getCString(s);
+        clang_disposeString(s);
+        return str;
+    }
+
+    bool isAssignment(const std::string& op) {
+        static const std::set<std::string> ops = {
+            "=", "+=", "-=", "*=", "/=", "%=", "&=", "|=", "^=", "<<=", ">>=", "++", "--"
+        };
+        return ops.count(op) > 0;
+    }
+
+    // true si le texte contient l'identifiant entier (pas seulement un morceau)
+    bool mentions(const std::string& text, const std::string& ident) {
+        if (ident.empty()) return false;
+        for (size_t pos = text.find(ident); pos != std::string::npos; pos = text.find(ident, pos + 1)) {
+            bool before = pos == 0 || !(std::isalnum(static_cast<unsigned char>(text[pos - 1])) || text[pos - 1] == '_');
+            size_t end = pos + ident.size();
+            bool after = end == text.size() || !(std::isalnum(static_cast<unsigned char>(text[end])) || text[end] == '_');
+            if (before && after) return true;
+        }
+        return false;
+    }
+
+    // Acces complet a[i][j] tel qu'il apparait dans le source
+    std::string accessText(const Subscript& sub) {
+        std::string text = sub.base;
+        for (auto& idx : sub.indices)
+            text += "[" + idx + "]";
+        return text;
+    }
+
+    // Decoupe les tokens d'un acces indice (tableau ou operator[]) en base et
+    // indices. La base d'un acces multidimensionnel est ignoree.
+    void addSubscript(CXCursor c, LoopScan& scan) {
+        CXSourceRange range = clang_getCursorExtent(c);
+        unsigned begin = offsetOf(clang_getRangeStart(range));
+        unsigned end = offsetOf(clang_getRangeEnd(range));
+        auto first = std::lower_bound(scan.tokens.begin(), scan.tokens.end(), begin,
+            [](const Token& t, unsigned off) { return t.offset < off; });
+        auto last = std::lower_bound(first, scan.tokens.end(), end,
+            [](const Token& t, unsigned off) { return t.offset < off; });
+
+        // base d'un acces multidimensionnel : seul l'acces complet compte
+        if (last != scan.tokens.end() && last->text == "[")
+            return;
+
+        Subscript sub;
+        int depth = 0;
+        for (auto it = first; it != last; ++it) {
+            if (it->text == "[" && depth++ == 0) {
+                sub.indices.emplace_back();
+                continue;
+            }
+            if (it->text == "]" && --depth == 0)
+                continue;
+            if (depth == 0)
+                sub.base += it->text;
+            else
+                sub.indices.back() += it->text;
+        }
+        sub.written = (last != scan.tokens.end() && isAssignment(last->text))
+            || (first != scan.tokens.begin()
+                && (std::prev(first)->text == "++" || std::prev(first)->text == "--"));
+        if (!sub.indices.empty())
+            scan.subscripts.push_back(std::move(sub));
+    }
+
+    CXChildVisitResult scanBody(CXCursor c, CXCursor, CXClientData clientData) {
+        auto* scan = reinterpret_cast<LoopScan*>(clientData);
+        CXCursorKind kind = clang_getCursorKind(c);
+
+        if (kind == CXCursor_CallExpr) {
+            CXCursor callee = clang_getCursorReferenced(c);
+            std::string name = spelling(clang_getCursorSpelling(c));
+            // v[i] sur un std::vector, std::array... : un acces indice comme un autre
+            if (name == "operator[]") {
+                addSubscript(c, *scan);
+                return CXChildVisit_Recurse;
+            }
+            // operateurs, constructeurs, fonctions inline et templates disparaissent
+            // a l'inlining ; une fonction opaque reste un appel, meme declaree
+            // dans un en-tete systeme (printf, rand, malloc, memcpy...)
+            bool ignored = name.empty() || name.rfind("operator", 0) == 0
+                || clang_getCursorKind(callee) == CXCursor_Constructor
+                || clang_Cursor_isFunctionInlined(callee)
+                || clang_getCursorKind(callee) == CXCursor_FunctionTemplate
+                || !clang_Cursor_isNull(clang_getSpecializedCursorTemplate(callee));
+            if (!ignored)
+                scan->calls.insert(name);
+        }
+        else if (kind == CXCursor_DeclRefExpr || kind == CXCursor_MemberRefExpr) {
+            CXType type = clang_getCanonicalType(clang_getCursorType(c));
+            std::string name = spelling(clang_getCursorSpelling(c));
+            if (type.kind == CXType_Pointer && !clang_isRestrictQualifiedType(type)) {
+                bool constPointee = clang_isConstQualifiedType(clang_getPointeeType(type));
+                scan->pointers.emplace(name, constPointee);
+            }
+            std::string typeName = spelling(clang_getTypeSpelling(type));
+            for (const char* container : kNonContiguous) {
+                if (typeName.rfind(container, 0) == 0 && typeName.size() > std::strlen(container)
+                    && typeName[std::strlen(container)] == '<') {
+                    scan->containers.insert(name + " (" + container + ")");
+                    break;
+                }
+            }
+        }
+        else if (kind == CXCursor_ArraySubscriptExpr) {
+            addSubscript(c, *scan);
+        }
+        return CXChildVisit_Recurse;
+    }
+
+#ifdef _WIN32
+    // Regles de decoupage de la ligne de commande du runtime C de Windows :
+    // guillemets autour de l'argument, barres obliques inverses doublees
+    // devant un guillemet ou la fin de l'argument.
+    std::string quoteArgument(const std::string& arg) {
+        if (!arg.empty() && arg.find_first_of(" \t\"") == std::string::npos)
+            return arg;
+        std::string quoted = "\"";
+        size_t backslashes = 0;
+        for (char ch : arg) {
+            if (ch == '\\') {
+                ++backslashes;
+                continue;
+            }
+            quoted.append(ch == '"' ? backslashes * 2 + 1 : backslashes, '\\');
+            quoted += ch;
+            backslashes = 0;
+        }
+        quoted.append(backslashes * 2, '\\');
+        return quoted + "\"";
+    }
+#endif
+
+    // Lance argv[0] sans passer par un shell et recupere sa sortie standard
+    // et sa sortie d'erreur melangees.
+    bool runCapture(const std::vector<std::string>& argv, std::string& output) {
+#ifdef _WIN32
+        SECURITY_ATTRIBUTES sa{ sizeof(sa), nullptr, TRUE };
+        HANDLE readEnd = nullptr, writeEnd = nullptr;
+        if (!CreatePipe(&readEnd, &writeEnd, &sa, 0))
+            return false;
+        SetHandleInformation(readEnd, HANDLE_FLAG_INHERIT, 0);
+
+        std::string cmdLine;
+        for (auto& arg : argv)
+            cmdLine += (cmdLine.empty() ? "" : " ") + quoteArgument(arg);
+
+        STARTUPINFOA si{};
+        si.cb = sizeof(si);
+        si.dwFlags = STARTF_USESTDHANDLES;
+        si.hStdInput = GetStdHandle(STD_INPUT_HANDLE);
+        si.hStdOutput = writeEnd;
+        si.hStdError = writeEnd;
+        PROCESS_INFORMATION pi{};
+        BOOL started = CreateProcessA(argv[0].c_str(), cmdLine.data(), nullptr, nullptr, TRUE,
+                                      CREATE_NO_WINDOW, nullptr, nullptr, &si, &pi);
+        CloseHandle(writeEnd);
+        if (!started) {
+            CloseHandle(readEnd);
+            return false;
+        }
+
+        char buf[4096];
+        DWORD n = 0;
+        while (ReadFile(readEnd, buf, sizeof(buf), &n, nullptr) && n > 0)
+            output.append(buf, n);
+        CloseHandle(readEnd);
+        WaitForSingleObject(pi.hProcess, INFINITE);
+        CloseHandle(pi.hProcess);
+        CloseHandle(pi.hThread);
+        return true;
+#else
+        int fds[2];
+        if (pipe(fds) != 0)
+            return false;
+
+        posix_spawn_file_actions_t actions;
+        posix_spawn_file_actions_init(&actions);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDOUT_FILENO);
+        posix_spawn_file_actions_adddup2(&actions, fds[1], STDERR_FILENO);
+        posix_spawn_file_actions_addclose(&actions, fds[0]);
+        posix_spawn_file_actions_addclose(&actions, fds[1]);
+
+        std::vector<char*> args;
+        for (auto& arg : argv)
+            args.push_back(const_cast<char*>(arg.c_str()));
+        args.push_back(nullptr);
+
+        pid_t pid = 0;
+        int rc = posix_spawn(&pid, argv[0].c_str(), &actions, nullptr, args.data(), environ);
+        posix_spawn_file_actions_destroy(&actions);
+        close(fds[1]);
+        if (rc != 0) {
+            close(fds[0]);
+            return false;
+        }
+
+        char buf[4096];
+        ssize_t n = 0;
+        while ((n = read(fds[0], buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR))
+            if (n > 0)
+                output.append(buf, static_cast<size_t>(n));
+        close(fds[0]);
+        int status = 0;
+        while (waitpid(pid, &status, 0) < 0 && errno == EINTR) {}
+        return true;
+#endif
+    }
+
+    bool isIdentifier(const std::string& token) {
+        return !token.empty() && (std::isalpha(static_cast<unsigned char>(token[0])) || token[0] == '_');
+    }
+
+    // Variable d'induction : celle affectee dans l'init d'un for (declaree ou
+    // non), sinon celle modifiee dans l'increment, sinon une variable de la
+    // condition modifiee dans la boucle (seul cas possible pour while et do).
+    std::string inductionVariable(const std::vector<Token>& tokens, CXCursorKind kind) {
+        // en-tete entre parentheses : apres for / while, ou apres le while final d'un do
+        size_t open = 1;
+        if (kind == CXCursor_DoStmt) {
+            open = tokens.size();
+            for (size_t i = tokens.size(); i-- > 0;) {
+                if (tokens[i].text == "while") {
+                    open = i + 1;
+                    break;
+                }
+            }
+        }
+        if (open >= tokens.size() || tokens[open].text != "(")
+            return {};
+
+        std::vector<size_t> semicolons;
+        size_t close = open;
+        for (int depth = 0; close < tokens.size(); ++close) {
+            const std::string& t = tokens[close].text;
+            if (t == "(")
+                ++depth;
+            else if (t == ")" && --depth == 0)
+                break;
+            else if (t == ";" && depth == 1)
+                semicolons.push_back(close);
+        }
+
+        auto modified = [&](size_t i) {
+            return isIdentifier(tokens[i].text)
+                && ((i > 0 && (tokens[i - 1].text == "++" || tokens[i - 1].text == "--"))
+                    || (i + 1 < tokens.size() && isAssignment(tokens[i + 1].text)));
+        };
+        std::set<std::string> written;
+        for (size_t i = 0; i < tokens.size(); ++i)
+            if (modified(i))
+                written.insert(tokens[i].text);
+
+        size_t condBegin = open + 1, condEnd = close;
+        if (kind == CXCursor_ForStmt) {
+            if (semicolons.size() != 2)
+                return {};
+            for (size_t i = open + 1; i < semicolons[0]; ++i)
+                if (tokens[i].text == "=" && isIdentifier(tokens[i - 1].text))
+                    return tokens[i - 1].text;
+            for (size_t i = semicolons[1] + 1; i < close; ++i)
+                if (modified(i))
+                    return tokens[i].text;
+            condBegin = semicolons[0] + 1;
+            condEnd = semicolons[1];
+        }
+        for (size_t i = condBegin; i < condEnd; ++i)
+            if (written.count(tokens[i].text))
+                return tokens[i].text;
+        return {};
+    }
+
+}
+
+const char* DragonEyes::toString(LoopBlocker blocker) {
+    switch (blocker) {
+    case LoopBlocker::PointerAliasing:       return "aliasing";
+    case LoopBlocker::FunctionCall:          return "call";
+    case LoopBlocker::LoopCarriedDependency: return "dependency";
+    case LoopBlocker::NonContiguousAccess:   return "non-contiguous";
+    }
+    return "unknown";
+}
+
+LoopAnalyzer::LoopAnalyzer(const std::vector<std::string>& args)
+    : clangPath_(findClang()) {
+    index_ = clang_createIndex(0, 0);
+    for (auto& a : args)
+        clangArgs_.push_back(a.c_str());
+}
+
+LoopAnalyzer::~LoopAnalyzer() {
+    clang_disposeIndex(index_);
+}
+
+void LoopAnalyzer::analyzeFile(const SourceFile& f) {
+    if (!f.exists) return;
+
+    CXTranslationUnit tu = clang_parseTranslationUnit(
+        index_,
+        f.path.c_str(),
+        clangArgs_.data(),
+        static_cast<int>(clangArgs_.size()),
+        nullptr, 0,
+        CXTranslationUnit_None
+    );
+    if (!tu) {
+        std::cerr << "Echec de l'analyse des boucles de " << f.path << "\n";
+        return;
+    }
+
+    std::vector<LoopReport> loops;
+    WalkContext ctx{ tu, f.path, {}, {}, &loops };
+    clang_visitChildren(clang_getTranslationUnitCursor(tu), walk, &ctx);
+    clang_disposeTranslationUnit(tu);
+
+    // un en-tete compile seul ne produit qu'un PCH, sans remarque du vectoriseur
+    if (clangPath_ && !loops.empty() && isTranslationUnit(f.path))
+        attachRemarks(f.path, loops);
+
+    for (auto& loop : loops)
+        loops_.push_back(std::move(loop));
+}
+
+CXChildVisitResult LoopAnalyzer::walk(CXCursor c, CXCursor parent, CXClientData clientData) {
+    auto* ctx = reinterpret_cast<WalkContext*>(clientData);
+    if (!clang_Location_isFromMainFile(clang_getCursorLocation(c)))
+        return CXChildVisit_Continue;
+
+    CXCursorKind kind = clang_getCursorKind(c);
+    switch (kind) {
+    case CXCursor_FunctionDecl:
+    case CXCursor_CXXMethod:
+    case CXCursor_Constructor:
+    case CXCursor_Destructor:
+    case CXCursor_FunctionTemplate: {
+        std::string saved = ctx->function;
+        ctx->function = spelling(clang_getCursorSpelling(c));
+        CXCursor semParent = clang_getCursorSemanticParent(c);
+        CXCursorKind pkind = clang_getCursorKind(semParent);
+        if (pkind == CXCursor_ClassDecl || pkind == CXCursor_StructDecl)
+            ctx->function = spelling(clang_getCursorSpelling(semParent)) + "::" + ctx->function;
+        clang_visitChildren(c, walk, clientData);
+        ctx->function = saved;
+        return CXChildVisit_Continue;
+    }
+
+    case CXCursor_ForStmt:
+    case CXCursor_CXXForRangeStmt:
+    case CXCursor_WhileStmt:
+    case CXCursor_DoStmt: {
+        LoopReport report;
+        report.file = ctx->file;
+        report.function = ctx->function;
+        report.kind = kind == CXCursor_ForStmt ? "for"
+            : kind == CXCursor_CXXForRangeStmt ? "range-for"
+            : kind == CXCursor_WhileStmt ? "while" : "do";
+        CXSourceRange range = clang_getCursorExtent(c);
+        clang_getSpellingLocation(clang_getRangeStart(range), nullptr, &report.line, &report.column, nullptr);
+        clang_getSpellingLocation(clang_getRangeEnd(range), nullptr, &report.endLine, nullptr, nullptr);
+        report.depth = static_cast<int>(ctx->loopStack.size());
+        if (!ctx->loopStack.empty())
+            (*ctx->loops)[ctx->loopStack.back()].innermost = false;
+
+        size_t index = ctx->loops->size();
+        ctx->loopStack.push_back(index);
+        ctx->loops->push_back(std::move(report));
+        clang_visitChildren(c, walk, clientData);
+        ctx->loopStack.pop_back();
+        // apres les boucles imbriquees : on sait si celle-ci est la plus interne
+        inspectLoop(ctx->tu, c, (*ctx->loops)[index]);
+        return CXChildVisit_Continue;
+    }
+
+    default:
+        return CXChildVisit_Recurse;
+    }
+}
+
+void LoopAnalyzer::inspectLoop(CXTranslationUnit tu, CXCursor loop, LoopReport& report) {
+    LoopScan scan;
+
+    CXToken* tokens = nullptr;
+    unsigned numTokens = 0;
+    clang_tokenize(tu, clang_getCursorExtent(loop), &tokens, &numTokens);
+    scan.tokens.reserve(numTokens);
+    for (unsigned i = 0; i < numTokens; ++i)
+        scan.tokens.push_back({ spelling(clang_getTokenSpelling(tu, tokens[i])),
+                                offsetOf(clang_getTokenLocation(tu, tokens[i])) });
+    clang_disposeTokens(tu, tokens, numTokens);
+
+    clang_visitChildren(loop, scanBody, &scan);
+    CXCursorKind kind = clang_getCursorKind(loop);
+    std::string var = kind == CXCursor_CXXForRangeStmt ? std::string() : inductionVariable(scan.tokens, kind);
+    // sans variable d'induction, dependances et ordre de parcours ne sont pas verifiables
+    report.inductionUnknown = var.empty() && kind != CXCursor_CXXForRangeStmt && !scan.subscripts.empty();
+
+    for (auto& name : scan.calls)
+        report.blockers.push_back({ LoopBlocker::FunctionCall, "appel a " + name + "()" });
+
+    // au moins deux pointeurs dont un modifiable : le compilateur doit supposer un chevauchement
+    bool writable = std::any_of(scan.pointers.begin(), scan.pointers.end(),
+        [](auto& p) { return !p.second; });
+    if (scan.pointers.size() >= 2 && writable) {
+        std::string names;
+        for (auto& [name, constPointee] : scan.pointers)
+            names += (names.empty() ? "" : ", ") + name;
+        report.blockers.push_back({ LoopBlocker::PointerAliasing,
+            "pointeurs " + names + " potentiellement aliases (__restrict ?)" });
+    }
+
+    for (auto& container : scan.containers)
+        report.blockers.push_back({ LoopBlocker::NonContiguousAccess, "conteneur non contigu " + container });
+
+    auto mentionsVar = [&](const Subscript& sub) {
+        return std::any_of(sub.indices.begin(), sub.indices.end(),
+            [&](auto& idx) { return mentions(idx, var); });
+    };
+
+    std::map<std::string, std::vector<const Subscript*>> byBase;
+    for (auto& sub : scan.subscripts) {
+        byBase[sub.base].push_back(&sub);
+        const std::string& last = sub.indices.back();
+        std::string access = accessText(sub);
+        if (last.find('[') != std::string::npos) {
+            report.blockers.push_back({ LoopBlocker::NonContiguousAccess, "acces indirect " + access });
+        }
+        // l'ordre de parcours ne compte que pour la boucle la plus interne,
+        // celle dont la variable varie le plus vite
+        else if (!report.innermost || var.empty()) {
+            continue;
+        } else if (!mentions(last, var)) {
+            if (mentionsVar(sub))
+                report.blockers.push_back({ LoopBlocker::NonContiguousAccess,
+                    "parcours par colonne " + access + " (" + var + " n'est pas le dernier indice)" });
+        } else if (last.find(var + "*") != std::string::npos || last.find("*" + var) != std::string::npos) {
+            report.blockers.push_back({ LoopBlocker::NonContiguousAccess, "acces avec pas " + access });
+        }
+    }
+
+    // dependance entre iterations : un meme tableau ecrit et accede a un autre indice
+    for (auto& [base, subs] : byBase) {
+        for (auto* w : subs) {
+            if (!w->written) continue;
+            std::string written = accessText(*w);
+            // aucun indice ne depend de l'iteration : la meme case est reecrite
+            if (!var.empty() && !mentionsVar(*w)) {
+                report.blockers.push_back({ LoopBlocker::LoopCarriedDependency,
+                    "ecriture de " + written + " a chaque iteration" });
+                break;
+            }
+            // seuls les indices qui dependent de la variable comptent :
+            // c[i][j] et c[i][j-1] ne dependent pas l'un de l'autre en i
+            auto other = std::find_if(subs.begin(), subs.end(), [&](auto* s) {
+                if (s->indices.size() != w->indices.size())
+                    return mentionsVar(*s);
+                for (size_t k = 0; k < s->indices.size(); ++k) {
+                    if (s->indices[k] != w->indices[k]
+                        && (mentions(s->indices[k], var) || mentions(w->indices[k], var)))
+                        return true;
+                }
+                return false;
+            });
+            if (other != subs.end()) {
+                report.blockers.push_back({ LoopBlocker::LoopCarriedDependency,
+                    written + " ecrit et " + accessText(**other) + " accede" });
+                break;
+            }
+        }
+    }
+
+    std::sort(report.blockers.begin(), report.blockers.end(), [](auto& a, auto& b) {
+        return std::tie(a.kind, a.detail) < std::tie(b.kind, b.detail);
+    });
+    report.blockers.erase(std::unique(report.blockers.begin(), report.blockers.end(), [](auto& a, auto& b) {
+        return a.kind == b.kind && a.detail == b.detail;
+    }), report.blockers.end());
+}
+
+// Compile le fichier avec les remarques du vectoriseur et rattache chacune a
+// la boucle la plus interne qui contient sa ligne.
+void LoopAnalyzer::attachRemarks(const std::string& path, std::vector<LoopReport>& loops) const {
+#ifdef _WIN32
+    const char* nullDevice = "NUL";
+#else
+    const char* nullDevice = "/dev/null";
+#endif
+    // arguments passes tels quels, sans shell : un chemin ne peut rien injecter
+    std::vector<std::string> argv = { *clangPath_, "-O2", "-c", path, "-o", nullDevice,
+        "-Rpass-missed=loop-vectorize", "-Rpass-analysis=loop-vectorize" };
+    for (auto* a : clangArgs_)
+        argv.emplace_back(a);
+
+    std::string output;
+    if (!runCapture(argv, output)) {
+        std::cerr << "Erreur: impossible de lancer " << *clangPath_ << "\n";
+        return;
+    }
+
+    static const std::regex remarkRe(R"(^(.*):(\d+):(\d+): remark: (.*?)(?: \[-Rpass[^\]]*\])?\r?$)");
+    std::string target = fs::path(path).filename().string();
+    size_t pos = 0;
+    while (pos < output.size()) {
+        size_t eol = output.find('\n', pos);
+        if (eol == std::string::npos) eol = output.size();
+        std::string line = output.substr(pos, eol - pos);
+        pos = eol + 1;
+
+        std::smatch m;
+        if (!std::regex_match(line, m, remarkRe))
+            continue;
+        if (fs::path(m[1].str()).filename().string() != target)
+            continue;
+        unsigned lineNo = static_cast<unsigned>(std::stoul(m[2].str()));
+
+        LoopReport* best = nullptr;
+        for (auto& loop : loops) {
+            if (lineNo < loop.line || lineNo > loop.endLine)
+                continue;
+            if (!best || loop.line > best->line || (loop.line == best->line && loop.depth > best->depth))
+                best = &loop;
+        }
+        if (best && std::find(best->remarks.begin(), best->remarks.end(), m[4].str()) == best->remarks.end())
+            best->remarks.push_back(m[4].str());
+    }
+}
+
+std::vector<LoopReport> LoopAnalyzer::ranked() const {
+    std::vector<LoopReport> result;
+    for (auto& loop : loops_) {
+        if (loop.blockers.empty() && loop.remarks.empty() && !loop.inductionUnknown)
+            continue;
+        LoopReport r = loop;
+        // les boucles internes et profondes sont les plus executees ; peu
+        // d'obstacles signifie un gain plus facile a obtenir
+        double weight = (r.innermost ? 2.0 : 1.0) * (1 + r.depth);
+        double findings = std::max(1.0, static_cast<double>(r.blockers.size() + r.remarks.size()));
+        r.score = weight * (r.remarks.empty() ? 1.0 : 2.0) / (1.0 + 0.25 * (findings - 1.0));
+        result.push_back(std::move(r));
+    }
+    std::stable_sort(result.begin(), result.end(), [](auto& a, auto& b) { return a.score > b.score; });
+    return result;
+}
+
+void LoopAnalyzer::writeText(const std::vector<LoopReport>& loops, std::ostream& out) {
+    out << std::fixed << std::setprecision(2);
+    out << "Boucles a rendre SIMD-friendly : " << loops.size() << "\n";
+    for (auto& loop : loops) {
+        out << "  - [" << loop.score << "] " << loop.file << ":" << loop.line << ":" << loop.column
+            << " " << loop.kind << " dans " << (loop.function.empty() ? "?" : loop.function)
+            << " (profondeur " << loop.depth << (loop.innermost ? ", interne" : "") << ")\n";
+        for (auto& b : loop.blockers)
+            out << "      " << DragonEyes::toString(b.kind) << " : " << b.detail << "\n";
+        for (auto& r : loop.remarks)
+            out << "      clang : " << r << "\n";
+        if (loop.inductionUnknown)
+            out << "      non analysee : variable d'induction introuvable, dependances et parcours non verifies\n";
+    }
+}
+
+void LoopAnalyzer::writeJson(const std::vector<LoopReport>& loops, std::ostream& out) {
+    out << std::fixed << std::setprecision(3);
+    out << "{\"loops\":[";
+    for (size_t i = 0; i < loops.size(); ++i) {
+        auto& loop = loops[i];
+        out << (i ? "," : "")
+            << "{\"file\":\"" << jsonEscape(loop.file)
+            << "\",\"function\":\"" << jsonEscape(loop.function)
+            << "\",\"kind\":\"" << loop.kind
+            << "\",\"line\":" << loop.line << ",\"column\":" << loop.column
+            << ",\"depth\":" << loop.depth
+            << ",\"innermost\":" << (loop.innermost ? "true" : "false")
+            << ",\"inductionUnknown\":" << (loop.inductionUnknown ? "true" : "false")
+            << ",\"score\":" << loop.score
+            << ",\"blockers\":[";
+        for (size_t j = 0; j < loop.blockers.size(); ++j)
+            out << (j ? "," : "") << "{\"kind\":\"" << DragonEyes::toString(loop.blockers[j].kind)
+                << "\",\"detail\":\"" << jsonEscape(loop.blockers[j].detail) << "\"}";
+        out << "],\"remarks\":[";
+        for (size_t j = 0; j < loop.remarks.size(); ++j)
+            out << (j ? "," : "") << "\"" << jsonEscape(loop.remarks[j]) << "\"";
+        out << "]}";
+    }
+    out << "]}\n";
+}
+
+std::optional<std::string> LoopAnalyzer::findClang() {
+    const char* env = std::getenv("PATH");
+    if (!env) return std::nullopt;
+#ifdef _WIN32
+    const char separator = ';';
+    const char* names[] = { "clang.exe" };
+#else
+    const char separator = ':';
+    const char* names[] = { "clang" };
+#endif
+    std::string paths = env;
+    size_t pos = 0;
+    while (pos <= paths.size()) {
+        size_t end = paths.find(separator, pos);
+        if (end == std::string::npos) end = paths.size();
+        fs::path dir = paths.substr(pos, end - pos);
+        pos = end + 1;
+        if (dir.empty()) continue;
+        for (const char* name : names) {
+            std::error_code ec;
+            if (fs::is_regular_file(dir / name, ec))
+                return (dir / name).string();
+        }
+    }
+    return std::nullopt;
+}
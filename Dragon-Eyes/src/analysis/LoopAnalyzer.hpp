@@ -0,0 +1,69 @@
+#ifndef LOOPANALYZER_HPP
+#define LOOPANALYZER_HPP
+
+#include <string>
+#include <vector>
+#include <optional>
+#include <ostream>
+#include "../data_model/DataModel.hpp"
+#include <clang-c/Index.h>
+
+namespace DragonEyes {
+
+    enum class LoopBlocker { PointerAliasing, FunctionCall, LoopCarriedDependency, NonContiguousAccess };
+
+    const char* toString(LoopBlocker blocker);
+
+    struct LoopFinding {
+        LoopBlocker kind;
+        std::string detail;
+    };
+
+    struct LoopReport {
+        std::string file;
+        std::string function;
+        std::string kind;               // for, range-for, while, do
+        unsigned line = 0;
+        unsigned column = 0;
+        unsigned endLine = 0;
+        int depth = 0;                  // nombre de boucles englobantes
+        bool innermost = true;
+        bool inductionUnknown = false;  // variable d'induction introuvable : boucle non analysee
+        std::vector<LoopFinding> blockers;
+        std::vector<std::string> remarks; // -Rpass-missed / -Rpass-analysis de clang
+        double score = 0.0;
+    };
+
+    // Cherche dans les corps de boucles ce qui empeche la vectorisation ou la
+    // parallelisation, et y rattache les remarques du vectoriseur de clang
+    // quand un binaire clang est disponible.
+    class LoopAnalyzer {
+    public:
+        LoopAnalyzer(const std::vector<std::string>& args);
+        ~LoopAnalyzer();
+
+        void analyzeFile(const SourceFile& f);
+
+        // Boucles avec au moins un obstacle ou une remarque, les plus
+        // interessantes a rendre SIMD-friendly en premier.
+        std::vector<LoopReport> ranked() const;
+
+        static void writeText(const std::vector<LoopReport>& loops, std::ostream& out);
+        static void writeJson(const std::vector<LoopReport>& loops, std::ostream& out);
+
+    private:
+        CXIndex index_;
+        std::vector<const char*> clangArgs_;
+        std::optional<std::string> clangPath_;
+        std::vector<LoopReport> loops_;
+
+        static CXChildVisitResult walk(CXCursor c, CXCursor parent, CXClientData clientData);
+        static void inspectLoop(CXTranslationUnit tu, CXCursor loop, LoopReport& report);
+        void attachRemarks(const std::string& path, std::vector<LoopReport>& loops) const;
+
+        static std::optional<std::string> findClang();
+    };
+
+}
+
+#endif // !LOOPANALYZER_HPP
@@ -23,10 +23,12 @@ namespace DragonEyes {
         std::vector<Variable> localVariables;
         std::vector<std::string> calledFunctions;
         AccessSpecifier access = AccessSpecifier::Private;
+        bool isDefinition = false;
     };
 
     struct CppClass {
         std::string name;
+        bool isDefinition = false;
         std::vector<std::string> baseClasses;
 
         std::vector<Variable> publicAttributes;
@@ -0,0 +1,278 @@
+#include "SymbolIndex.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <unordered_set>
+
+using namespace DragonEyes;
+
+namespace {
+
+    const char* const kKindNames[kSymbolKindCount] = {
+        "class", "method", "attribute", "function", "global", "alias"
+    };
+
+    const std::vector<uint32_t> kEmpty;
+
+    std::string toLower(std::string_view s) {
+        std::string out(s);
+        std::transform(out.begin(), out.end(), out.begin(),
+            [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+        return out;
+    }
+
+    uint32_t unigramAt(std::string_view s, size_t i) {
+        return static_cast<unsigned char>(s[i]);
+    }
+
+    uint32_t bigramAt(std::string_view s, size_t i) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(s[i])) << 8)
+            | static_cast<uint32_t>(static_cast<unsigned char>(s[i + 1]));
+    }
+
+    uint32_t trigramAt(std::string_view s, size_t i) {
+        return (static_cast<uint32_t>(static_cast<unsigned char>(s[i])) << 16)
+            | (static_cast<uint32_t>(static_cast<unsigned char>(s[i + 1])) << 8)
+            | static_cast<uint32_t>(static_cast<unsigned char>(s[i + 2]));
+    }
+
+    std::string signatureOf(const Function& fn) {
+        std::string sig = "(";
+        for (size_t i = 0; i < fn.parameters.size(); ++i)
+            sig += (i ? ", " : "") + fn.parameters[i].type;
+        return sig + ")";
+    }
+
+}
+
+const char* DragonEyes::toString(SymbolKind kind) {
+    return kKindNames[static_cast<int>(kind)];
+}
+
+std::optional<SymbolKind> DragonEyes::symbolKindFromString(std::string_view s) {
+    for (int i = 0; i < kSymbolKindCount; ++i)
+        if (s == kKindNames[i])
+            return static_cast<SymbolKind>(i);
+    return std::nullopt;
+}
+
+SymbolIndex SymbolIndex::build(const Solution& sol) {
+    SymbolIndex index;
+    // une methode declaree puis definie apparait deux fois dans le modele ;
+    // la cle ne couvre qu'un fichier, l'ensemble est vide a chaque fichier
+    std::unordered_set<std::string> seen;
+
+    auto addUnique = [&](Symbol sym) {
+        std::string key = std::string(toString(sym.kind)) + '|' + sym.qualifiedName + '|' + sym.type;
+        if (seen.insert(std::move(key)).second)
+            index.add(std::move(sym));
+    };
+
+    for (auto& proj : sol.projects) {
+        for (auto& file : proj.files) {
+            // un en-tete partage par plusieurs projets n'est indexe qu'une fois
+            auto [it, inserted] = index.fileIds_.try_emplace(file.path, static_cast<uint32_t>(index.files_.size()));
+            if (!inserted)
+                continue;
+            index.files_.push_back(file.path);
+            index.byFile_.emplace_back();
+            uint32_t fileId = it->second;
+            seen.clear();
+
+            for (auto& cls : file.classes) {
+                // classe des methodes definies hors ligne : seule sa definition est un symbole
+                if (cls.isDefinition)
+                    addUnique({ cls.name, cls.name, cls.name, SymbolKind::Class, fileId });
+                for (auto* group : { &cls.publicAttributes, &cls.protectedAttributes, &cls.privateAttributes })
+                    for (auto& attr : *group)
+                        addUnique({ attr.name, cls.name + "::" + attr.name, attr.type, SymbolKind::Attribute, fileId });
+                for (auto* group : { &cls.publicMethods, &cls.protectedMethods, &cls.privateMethods })
+                    for (auto& m : *group)
+                        addUnique({ m.name, cls.name + "::" + m.name, signatureOf(m), SymbolKind::Method, fileId });
+            }
+            for (auto& fn : file.functions)
+                addUnique({ fn.name, fn.name, signatureOf(fn), SymbolKind::Function, fileId });
+            for (auto& var : file.globals)
+                addUnique({ var.name, var.name, var.type, SymbolKind::Global, fileId });
+            for (auto& alias : file.aliases)
+                addUnique({ alias.name, alias.name, alias.underlyingType, SymbolKind::Alias, fileId });
+        }
+    }
+
+    index.finalize();
+    return index;
+}
+
+void SymbolIndex::add(Symbol sym) {
+    uint32_t id = static_cast<uint32_t>(symbols_.size());
+
+    lowerNames_.push_back(toLower(sym.name));
+    lowerQualified_.push_back(toLower(sym.qualifiedName));
+    prefixEntries_.push_back(id << 1);
+    if (lowerQualified_.back() != lowerNames_.back())
+        prefixEntries_.push_back((id << 1) | 1);
+
+    // les ids sont croissants : les listes restent triees
+    const std::string& q = lowerQualified_.back();
+    std::vector<uint32_t> grams;
+    auto addGrams = [&](auto& lists, size_t n, uint32_t (*gramAt)(std::string_view, size_t)) {
+        grams.clear();
+        for (size_t i = 0; i + n <= q.size(); ++i)
+            grams.push_back(gramAt(q, i));
+        std::sort(grams.begin(), grams.end());
+        grams.erase(std::unique(grams.begin(), grams.end()), grams.end());
+        for (uint32_t g : grams)
+            lists[g].push_back(id);
+    };
+    addGrams(unigrams_, 1, unigramAt);
+    addGrams(bigrams_, 2, bigramAt);
+    addGrams(trigrams_, 3, trigramAt);
+
+    byType_[sym.type].push_back(id);
+    byFile_[sym.file].push_back(id);
+    byKind_[static_cast<int>(sym.kind)].push_back(id);
+    symbols_.push_back(std::move(sym));
+}
+
+void SymbolIndex::finalize() {
+    std::sort(prefixEntries_.begin(), prefixEntries_.end(), [this](uint32_t a, uint32_t b) {
+        return keyOf(a) < keyOf(b);
+    });
+}
+
+std::string_view SymbolIndex::keyOf(uint32_t entry) const {
+    uint32_t id = entry >> 1;
+    return (entry & 1) ? lowerQualified_[id] : lowerNames_[id];
+}
+
+std::vector<uint32_t> SymbolIndex::findPrefix(std::string_view prefix, size_t limit) const {
+    SymbolQuery query;
+    query.text = prefix;
+    query.limit = limit;
+    return search(query);
+}
+
+std::vector<uint32_t> SymbolIndex::findSubstring(std::string_view text, size_t limit) const {
+    SymbolQuery query;
+    query.text = text;
+    query.substring = true;
+    query.limit = limit;
+    return search(query);
+}
+
+const std::vector<uint32_t>& SymbolIndex::findByType(const std::string& type) const {
+    auto it = byType_.find(type);
+    return it != byType_.end() ? it->second : kEmpty;
+}
+
+const std::vector<uint32_t>& SymbolIndex::findInFile(const std::string& path) const {
+    auto it = fileIds_.find(path);
+    return it != fileIds_.end() ? byFile_[it->second] : kEmpty;
+}
+
+const std::vector<uint32_t>& SymbolIndex::findByKind(SymbolKind kind) const {
+    return byKind_[static_cast<int>(kind)];
+}
+
+bool SymbolIndex::matches(uint32_t id, const SymbolQuery& query) const {
+    const Symbol& sym = symbols_[id];
+    if (query.kind && sym.kind != *query.kind) return false;
+    if (query.file && files_[sym.file] != *query.file) return false;
+    if (query.type && sym.type != *query.type) return false;
+    return true;
+}
+
+std::vector<uint32_t> SymbolIndex::search(const SymbolQuery& query) const {
+    std::vector<uint32_t> result;
+    if (query.limit == 0)
+        return result;
+    std::string text = toLower(query.text);
+
+    auto startsWith = [&text](std::string_view key) {
+        return key.compare(0, text.size(), text) == 0;
+    };
+
+    // Liste de filtre (nature, fichier, type) la plus courte
+    const std::vector<uint32_t>* candidates = nullptr;
+    auto consider = [&](const std::vector<uint32_t>& list) {
+        if (!candidates || list.size() < candidates->size())
+            candidates = &list;
+    };
+    if (query.kind) consider(findByKind(*query.kind));
+    if (query.file) consider(findInFile(*query.file));
+    if (query.type) consider(findByType(*query.type));
+
+    // Prefixe : plage contigue du tableau trie, sauf si un filtre est plus court
+    if (!text.empty() && !query.substring) {
+        auto first = std::lower_bound(prefixEntries_.begin(), prefixEntries_.end(), text,
+            [this](uint32_t entry, const std::string& t) { return keyOf(entry) < t; });
+        auto last = std::partition_point(first, prefixEntries_.end(),
+            [&](uint32_t entry) { return startsWith(keyOf(entry)); });
+
+        if (candidates && candidates->size() < static_cast<size_t>(last - first)) {
+            for (auto it = candidates->begin(); it != candidates->end() && result.size() < query.limit; ++it) {
+                if ((startsWith(lowerNames_[*it]) || startsWith(lowerQualified_[*it])) && matches(*it, query))
+                    result.push_back(*it);
+            }
+            return result;
+        }
+
+        for (auto it = first; it != last && result.size() < query.limit; ++it) {
+            uint32_t id = *it >> 1;
+            // nom qualifie deja couvert par l'entree du nom court
+            if ((*it & 1) && startsWith(lowerNames_[id]))
+                continue;
+            if (matches(id, query))
+                result.push_back(id);
+        }
+        return result;
+    }
+
+    // Sous-chaine : liste de trigramme la plus courte puis verification
+    if (!text.empty() && text.size() >= 3) {
+        // la liste la plus courte suffit : verifier la sous-chaine coute moins
+        // cher que d'intersecter des listes plus longues
+        const std::vector<uint32_t>* shortest = candidates;
+        for (size_t i = 0; i + 2 < text.size(); ++i) {
+            auto it = trigrams_.find(trigramAt(text, i));
+            if (it == trigrams_.end())
+                return result;
+            if (!shortest || it->second.size() < shortest->size())
+                shortest = &it->second;
+        }
+        for (uint32_t id : *shortest) {
+            if (lowerQualified_[id].find(text) != std::string::npos && matches(id, query)) {
+                result.push_back(id);
+                if (result.size() >= query.limit)
+                    break;
+            }
+        }
+        return result;
+    }
+
+    // Un ou deux caracteres : la liste du n-gramme contient exactement les
+    // symboles qui correspondent, sauf si un filtre est plus court
+    if (!text.empty()) {
+        const std::vector<uint32_t>& list = text.size() == 1 ? unigrams_[unigramAt(text, 0)] : bigrams_[bigramAt(text, 0)];
+        if (list.empty())
+            return result;
+        if (!candidates || list.size() < candidates->size())
+            candidates = &list;
+    }
+
+    // Liste la plus courte (filtre ou n-gramme) puis verification ; sans texte
+    // ni filtre, chaque symbole correspond et le parcours s'arrete a la limite
+    auto visit = [&](uint32_t id) {
+        if (!matches(id, query)) return;
+        if (!text.empty() && lowerQualified_[id].find(text) == std::string::npos) return;
+        result.push_back(id);
+    };
+    if (candidates) {
+        for (auto it = candidates->begin(); it != candidates->end() && result.size() < query.limit; ++it)
+            visit(*it);
+    } else {
+        for (uint32_t id = 0; id < symbols_.size() && result.size() < query.limit; ++id)
+            visit(id);
+    }
+    return result;
+}
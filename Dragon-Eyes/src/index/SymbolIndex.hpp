@@ -0,0 +1,88 @@
+#ifndef SYMBOLINDEX_HPP
+#define SYMBOLINDEX_HPP
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <optional>
+#include <unordered_map>
+#include <cstdint>
+#include "../data_model/DataModel.hpp"
+
+namespace DragonEyes {
+
+    enum class SymbolKind : uint8_t { Class = 0, Method, Attribute, Function, Global, Alias };
+
+    constexpr int kSymbolKindCount = 6;
+
+    const char* toString(SymbolKind kind);
+    std::optional<SymbolKind> symbolKindFromString(std::string_view s);
+
+    struct Symbol {
+        std::string name;
+        std::string qualifiedName;  // Classe::membre pour les membres
+        std::string type;           // type de la variable, signature pour une fonction
+        SymbolKind kind = SymbolKind::Function;
+        uint32_t file = 0;          // indice dans SymbolIndex::files()
+    };
+
+    struct SymbolQuery {
+        std::string text;                   // vide : pas de filtre sur le nom
+        bool substring = false;             // false : recherche par prefixe
+        std::optional<SymbolKind> kind;
+        std::optional<std::string> file;
+        std::optional<std::string> type;
+        size_t limit = 50;
+    };
+
+    // Index des symboles du modele : prefixe (tableau trie, equivalent a un
+    // trie aplati), n-grammes de 1 a 3 caracteres pour les sous-chaines, et
+    // listes par type, fichier et nature. Seule une requete sans texte ni
+    // filtre parcourt les symboles dans l'ordre ; tous correspondent, le
+    // parcours s'arrete donc apres `limit` symboles.
+    class SymbolIndex {
+    public:
+        static SymbolIndex build(const Solution& sol);
+
+        const std::vector<Symbol>& symbols() const { return symbols_; }
+        const std::vector<std::string>& files() const { return files_; }
+        const Symbol& symbol(uint32_t id) const { return symbols_[id]; }
+
+        // Nom court ou qualifie commencant par le prefixe (sans casse).
+        std::vector<uint32_t> findPrefix(std::string_view prefix, size_t limit) const;
+        // Nom qualifie contenant le texte (sans casse).
+        std::vector<uint32_t> findSubstring(std::string_view text, size_t limit) const;
+
+        const std::vector<uint32_t>& findByType(const std::string& type) const;
+        const std::vector<uint32_t>& findInFile(const std::string& path) const;
+        const std::vector<uint32_t>& findByKind(SymbolKind kind) const;
+
+        // Combine les criteres de la requete en partant de la liste la plus courte.
+        std::vector<uint32_t> search(const SymbolQuery& query) const;
+
+    private:
+        std::vector<Symbol> symbols_;
+        std::vector<std::string> files_;
+        std::vector<std::string> lowerNames_;
+        std::vector<std::string> lowerQualified_;
+
+        // (id << 1) | 1 si la cle est le nom qualifie, trie par cle
+        std::vector<uint32_t> prefixEntries_;
+        // 1 et 2 caracteres : tables indexees directement par le n-gramme
+        std::vector<std::vector<uint32_t>> unigrams_ = std::vector<std::vector<uint32_t>>(1 << 8);
+        std::vector<std::vector<uint32_t>> bigrams_ = std::vector<std::vector<uint32_t>>(1 << 16);
+        std::unordered_map<uint32_t, std::vector<uint32_t>> trigrams_;
+        std::unordered_map<std::string, std::vector<uint32_t>> byType_;
+        std::unordered_map<std::string, uint32_t> fileIds_;
+        std::vector<std::vector<uint32_t>> byFile_;
+        std::vector<uint32_t> byKind_[kSymbolKindCount];
+
+        std::string_view keyOf(uint32_t entry) const;
+        void add(Symbol sym);
+        void finalize();
+        bool matches(uint32_t id, const SymbolQuery& query) const;
+    };
+
+} // namespace DragonEyes
+
+#endif // !SYMBOLINDEX_HPP
@@ -3,21 +3,29 @@
 #include <vector>
 #include <chrono>
 #include <filesystem>
+#include <fstream>
+#include <charconv>
 
 #include "parsers/visual_studio/SlnParser.hpp"
 #include "data_model/DataModel.hpp"
 #include "parsers/code/ASTParser.hpp"
 #include "parsers/visual_studio/VcxprojParser.hpp"
+#include "map/CodeMap.hpp"
+#include "map/MapExporter.hpp"
+#include "analysis/BuildCostAnalyzer.hpp"
+#include "analysis/LoopAnalyzer.hpp"
+#include "index/SymbolIndex.hpp"
 
-int main(int argc, char* argv[]) {
-    if (argc != 2) {
-        std::cerr << "Usage: dragon-eyes <solution.sln>\n";
-        return 1;
-    }
-
-    std::string inputPath = argv[1];
-    DragonEyes::Solution sol;
+static void printUsage() {
+    std::cerr << "Usage: dragon-eyes <solution.sln>\n"
+        << "       dragon-eyes map <solution.sln> [--output <dossier>] [--vertical|--horizontal]\n"
+        << "       dragon-eyes build-cost <solution.sln> [--output <rapport.json>]\n"
+        << "       dragon-eyes loops <solution.sln> [--output <rapport.json>]\n"
+        << "       dragon-eyes search <solution.sln> [texte] [--substring] [--kind <nature>]\n"
+        << "                          [--file <chemin>] [--type <type>] [--limit <n>]\n";
+}
 
+static bool loadSolution(const std::string& inputPath, DragonEyes::Solution& sol) {
     std::filesystem::path p(inputPath);
     auto ext = p.extension().string();
     if (ext == ".sln") {
@@ -33,12 +41,147 @@ int main(int argc, char* argv[]) {
     } else {
         std::cerr << "Erreur: format non supporte ("
             << ext << "). Utilisez .sln ou .vcxproj.\n";
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<std::string> args(argv + 1, argv + argc);
+    std::string command;
+    if (!args.empty() && (args[0] == "map" || args[0] == "build-cost"
+        || args[0] == "loops" || args[0] == "search")) {
+        command = args[0];
+        args.erase(args.begin());
+    }
+
+    std::string inputPath;
+    std::string outputPath;
+    DragonEyes::MapOptions mapOptions;
+    DragonEyes::SymbolQuery query;
+    for (size_t i = 0; i < args.size(); ++i) {
+        if (args[i] == "--output" && i + 1 < args.size()) {
+            outputPath = args[++i];
+        } else if (args[i] == "--horizontal") {
+            mapOptions.orientation = DragonEyes::MapOrientation::Horizontal;
+        } else if (args[i] == "--vertical") {
+            mapOptions.orientation = DragonEyes::MapOrientation::Vertical;
+        } else if (args[i] == "--substring") {
+            query.substring = true;
+        } else if (args[i] == "--kind" && i + 1 < args.size()) {
+            query.kind = DragonEyes::symbolKindFromString(args[++i]);
+            if (!query.kind) {
+                std::cerr << "Erreur: nature inconnue (" << args[i]
+                    << "). Valeurs : class, method, attribute, function, global, alias.\n";
+                return 1;
+            }
+        } else if (args[i] == "--file" && i + 1 < args.size()) {
+            query.file = args[++i];
+        } else if (args[i] == "--type" && i + 1 < args.size()) {
+            query.type = args[++i];
+        } else if (args[i] == "--limit" && i + 1 < args.size()) {
+            const std::string& value = args[++i];
+            auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), query.limit);
+            if (ec != std::errc() || end != value.data() + value.size() || query.limit == 0) {
+                std::cerr << "Erreur: limite invalide (" << value << "), entier positif attendu.\n";
+                return 1;
+            }
+        } else if (inputPath.empty()) {
+            inputPath = args[i];
+        } else if (command == "search" && query.text.empty()) {
+            query.text = args[i];
+        } else {
+            printUsage();
+            return 1;
+        }
+    }
+    if (inputPath.empty()) {
+        printUsage();
         return 1;
     }
 
+    DragonEyes::Solution sol;
+    if (!loadSolution(inputPath, sol))
+        return 1;
+
     std::vector<std::string> clangArgs = {"-std=c++20"};
     DragonEyes::ASTParser astParser(clangArgs);
 
+    if (command == "map") {
+        for (auto& proj : sol.projects)
+            for (auto& file : proj.files)
+                astParser.parseFile(file);
+
+        DragonEyes::CodeMap map = DragonEyes::CodeMap::build(sol);
+        DragonEyes::MapExporter exporter(mapOptions);
+        std::string outputDir = outputPath.empty() ? "map" : outputPath;
+        if (!exporter.exportTiles(map, outputDir))
+            return 1;
+        std::cout << "Carte ecrite dans " << outputDir << " : "
+            << map.nodes().size() << " noeuds, "
+            << map.calls().size() << " appels\n";
+        return 0;
+    }
+
+    if (command == "build-cost") {
+        DragonEyes::BuildCostAnalyzer analyzer(clangArgs);
+        for (auto& proj : sol.projects)
+            for (auto& file : proj.files)
+                analyzer.analyzeFile(file);
+
+        DragonEyes::BuildCostReport report = analyzer.report();
+        DragonEyes::BuildCostAnalyzer::writeText(report, std::cout);
+        if (!outputPath.empty()) {
+            std::ofstream out(outputPath);
+            if (!out) {
+                std::cerr << "Erreur: impossible d'ecrire " << outputPath << "\n";
+                return 1;
+            }
+            DragonEyes::BuildCostAnalyzer::writeJson(report, out);
+        }
+        return 0;
+    }
+
+    if (command == "loops") {
+        DragonEyes::LoopAnalyzer analyzer(clangArgs);
+        for (auto& proj : sol.projects)
+            for (auto& file : proj.files)
+                analyzer.analyzeFile(file);
+
+        std::vector<DragonEyes::LoopReport> loops = analyzer.ranked();
+        DragonEyes::LoopAnalyzer::writeText(loops, std::cout);
+        if (!outputPath.empty()) {
+            std::ofstream out(outputPath);
+            if (!out) {
+                std::cerr << "Erreur: impossible d'ecrire " << outputPath << "\n";
+                return 1;
+            }
+            DragonEyes::LoopAnalyzer::writeJson(loops, out);
+        }
+        return 0;
+    }
+
+    if (command == "search") {
+        for (auto& proj : sol.projects)
+            for (auto& file : proj.files)
+                astParser.parseFile(file);
+
+        DragonEyes::SymbolIndex index = DragonEyes::SymbolIndex::build(sol);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<uint32_t> results = index.search(query);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::steady_clock::now() - start).count();
+
+        for (uint32_t id : results) {
+            auto& sym = index.symbol(id);
+            std::cout << DragonEyes::toString(sym.kind) << "\t" << sym.qualifiedName
+                << "\t" << sym.type << "\t" << index.files()[sym.file] << "\n";
+        }
+        std::cerr << results.size() << " resultat(s) sur " << index.symbols().size()
+            << " symboles en " << elapsed << " us\n";
+        return 0;
+    }
+
     for (auto& proj : sol.projects) {
         std::cout << "Projet : " << proj.name << "\n";
         for (auto& file : proj.files) {
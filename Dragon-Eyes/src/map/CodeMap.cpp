@@ -0,0 +1,180 @@
+#include "CodeMap.hpp"
+
+#include <algorithm>
+#include <filesystem>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace fs = std::filesystem;
+using namespace DragonEyes;
+
+namespace {
+
+    struct PendingCall {
+        uint32_t caller;
+        uint32_t file;
+        const std::string* callee;
+    };
+
+    // Cle de fusion d'une declaration avec sa definition : une fonction
+    // declaree dans un en-tete puis definie dans un .cpp apparait dans les
+    // deux fichiers du modele.
+    std::string signatureKey(const Function& fn) {
+        std::string key = fn.name + "(";
+        for (auto& p : fn.parameters)
+            key += p.type + ",";
+        return key + ")";
+    }
+
+}
+
+const char* DragonEyes::toString(MapLevel level) {
+    switch (level) {
+    case MapLevel::Solution: return "solution";
+    case MapLevel::Project:  return "project";
+    case MapLevel::File:     return "file";
+    case MapLevel::Class:    return "class";
+    case MapLevel::Function: return "function";
+    }
+    return "unknown";
+}
+
+uint32_t CodeMap::addNode(std::string label, MapLevel level, uint32_t parent) {
+    uint32_t id = static_cast<uint32_t>(nodes_.size());
+    MapNode n;
+    n.label = std::move(label);
+    n.level = level;
+    n.parent = parent;
+    nodes_.push_back(std::move(n));
+    if (parent != npos)
+        nodes_[parent].children.push_back(id);
+    return id;
+}
+
+uint32_t CodeMap::ancestorAt(uint32_t node, MapLevel level) const {
+    while (node != npos && nodes_[node].level > level)
+        node = nodes_[node].parent;
+    return node;
+}
+
+CodeMap CodeMap::build(const Solution& sol) {
+    CodeMap map;
+    std::vector<PendingCall> pending;
+
+    uint32_t root = map.addNode(fs::path(sol.path).filename().string(), MapLevel::Solution, npos);
+
+    // 1) noeuds des fichiers, dans l'ordre du modele
+    struct FileRef {
+        const SourceFile* file;
+        uint32_t node;
+        size_t project;
+    };
+    std::vector<FileRef> files;
+    for (size_t p = 0; p < sol.projects.size(); ++p) {
+        auto& proj = sol.projects[p];
+        uint32_t projNode = map.addNode(proj.name, MapLevel::Project, root);
+        for (auto& file : proj.files)
+            files.push_back({ &file, map.addNode(fs::path(file.path).filename().string(), MapLevel::File, projNode), p });
+    }
+
+    // 2) classes : chaque definition a son noeud. Une simple declaration (la
+    // classe des methodes definies hors ligne dans un .cpp) rejoint la
+    // definition de son projet, a defaut celle d'un autre projet.
+    std::unordered_map<const CppClass*, uint32_t> classOf;
+    std::unordered_map<std::string, std::vector<std::pair<size_t, uint32_t>>> classDefs; // nom -> (projet, noeud)
+    for (auto& f : files) {
+        for (auto& cls : f.file->classes) {
+            if (!cls.isDefinition)
+                continue;
+            uint32_t node = map.addNode(cls.name, MapLevel::Class, f.node);
+            classOf[&cls] = node;
+            classDefs[cls.name].emplace_back(f.project, node);
+        }
+    }
+    std::unordered_map<std::string, uint32_t> classStubs; // projet|nom -> noeud
+    for (auto& f : files) {
+        for (auto& cls : f.file->classes) {
+            if (cls.isDefinition)
+                continue;
+            auto defs = classDefs.find(cls.name);
+            if (defs != classDefs.end()) {
+                auto same = std::find_if(defs->second.begin(), defs->second.end(),
+                    [&](auto& d) { return d.first == f.project; });
+                classOf[&cls] = (same != defs->second.end() ? *same : defs->second.front()).second;
+                continue;
+            }
+            auto [stub, inserted] = classStubs.try_emplace(std::to_string(f.project) + "|" + cls.name, npos);
+            if (inserted)
+                stub->second = map.addNode(cls.name, MapLevel::Class, f.node);
+            classOf[&cls] = stub->second;
+        }
+    }
+
+    // 3) fonctions : chaque definition a son noeud, meme a signature egale
+    // (helpers static de deux .cpp, main de chaque executable) ; une
+    // declaration n'a de noeud que si aucune definition ne la porte
+    std::unordered_map<uint32_t, uint32_t> definingFile;
+    std::unordered_map<std::string, std::vector<uint32_t>> functionsByName;
+    auto addFunction = [&](const Function& fn, uint32_t parent, uint32_t fileNode, std::string label) {
+        uint32_t node = map.addNode(std::move(label), MapLevel::Function, parent);
+        definingFile[node] = fileNode;
+        functionsByName[fn.name].push_back(node);
+        for (auto& called : fn.calledFunctions)
+            pending.push_back({ node, fileNode, &called });
+    };
+    std::unordered_set<std::string> covered;
+    for (bool definitions : { true, false }) {
+        for (auto& f : files) {
+            for (auto& cls : f.file->classes) {
+                uint32_t classNode = classOf[&cls];
+                for (auto* group : { &cls.publicMethods, &cls.protectedMethods, &cls.privateMethods }) {
+                    for (auto& m : *group) {
+                        if (m.isDefinition != definitions)
+                            continue;
+                        bool fresh = covered.insert(std::to_string(classNode) + "::" + signatureKey(m)).second;
+                        if (definitions || fresh)
+                            addFunction(m, classNode, f.node, cls.name + "::" + m.name);
+                    }
+                }
+            }
+            for (auto& fn : f.file->functions) {
+                if (fn.isDefinition != definitions)
+                    continue;
+                bool fresh = covered.insert(signatureKey(fn)).second;
+                if (definitions || fresh)
+                    addFunction(fn, f.node, f.node, fn.name);
+            }
+        }
+    }
+
+    // Resolution des appels par nom : on prefere une cible du meme fichier,
+    // sinon on ne garde l'appel que s'il n'est pas ambigu.
+    map.calls_.reserve(pending.size());
+    for (auto& call : pending) {
+        auto it = functionsByName.find(*call.callee);
+        if (it == functionsByName.end())
+            continue;
+        uint32_t target = npos;
+        for (uint32_t candidate : it->second) {
+            if (definingFile[candidate] == call.file) {
+                target = candidate;
+                break;
+            }
+        }
+        if (target == npos && it->second.size() == 1)
+            target = it->second.front();
+        if (target != npos)
+            map.calls_.emplace_back(call.caller, target);
+    }
+
+    // poids : les enfants sont toujours crees apres leur parent
+    for (size_t i = map.nodes_.size(); i-- > 0;) {
+        MapNode& n = map.nodes_[i];
+        if (n.level == MapLevel::Function)
+            n.weight = 1;
+        if (n.parent != npos)
+            map.nodes_[n.parent].weight += n.weight;
+    }
+
+    return map;
+}
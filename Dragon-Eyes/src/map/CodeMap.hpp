@@ -0,0 +1,50 @@
+#ifndef CODEMAP_HPP
+#define CODEMAP_HPP
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include "../data_model/DataModel.hpp"
+
+namespace DragonEyes {
+
+    // Niveaux de la hierarchie : solution -> projet -> fichier -> classe -> fonction
+    enum class MapLevel : uint8_t { Solution = 0, Project, File, Class, Function };
+
+    constexpr int kMapLevelCount = 5;
+
+    const char* toString(MapLevel level);
+
+    struct MapNode {
+        std::string label;
+        MapLevel level = MapLevel::Solution;
+        uint32_t parent = UINT32_MAX;   // UINT32_MAX pour la racine
+        std::vector<uint32_t> children;
+        uint32_t weight = 0;            // nombre de fonctions sous ce noeud
+    };
+
+    class CodeMap {
+    public:
+        static constexpr uint32_t npos = UINT32_MAX;
+
+        // Construit le regroupement hierarchique et le graphe d'appels
+        // (fonction -> fonction) a partir du modele deja analyse.
+        static CodeMap build(const Solution& sol);
+
+        const std::vector<MapNode>& nodes() const { return nodes_; }
+        const std::vector<std::pair<uint32_t, uint32_t>>& calls() const { return calls_; }
+
+        // Premier ancetre (ou le noeud lui-meme) visible au niveau donne.
+        uint32_t ancestorAt(uint32_t node, MapLevel level) const;
+
+    private:
+        std::vector<MapNode> nodes_;
+        std::vector<std::pair<uint32_t, uint32_t>> calls_;
+
+        uint32_t addNode(std::string label, MapLevel level, uint32_t parent);
+    };
+
+} // namespace DragonEyes
+
+#endif // !CODEMAP_HPP
@@ -0,0 +1,225 @@
+#include "MapExporter.hpp"
+#include "../utils/Json.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+using namespace DragonEyes;
+
+namespace {
+
+    struct Tile {
+        std::vector<uint32_t> nodes;
+        std::vector<std::pair<uint64_t, uint32_t>> edges; // (from << 32 | to, nombre d'appels)
+    };
+
+    using TileKey = std::pair<long long, long long>;
+
+}
+
+MapExporter::MapExporter(const MapOptions& options)
+    : options_(options) {
+}
+
+void MapExporter::toPosition(const MapNode& n, const Placement& p, double& x, double& y) const {
+    double along = p.breadth * options_.nodeSpacing;
+    double depth = static_cast<double>(n.level) * options_.levelSpacing;
+    if (options_.orientation == MapOrientation::Vertical) {
+        x = along;
+        y = depth;
+    } else {
+        x = depth;
+        y = along;
+    }
+}
+
+// Placement en arbre : chaque feuille visible recoit une case, un parent est
+// centre sur ses enfants. Les noeuds plus profonds que le niveau sont masques.
+std::vector<MapExporter::Placement> MapExporter::layoutLevel(const CodeMap& map, MapLevel level) const {
+    const auto& nodes = map.nodes();
+    std::vector<Placement> placement(nodes.size());
+    if (nodes.empty())
+        return placement;
+
+    // parcours post-ordre iteratif (la hierarchie peut etre tres large)
+    double nextSlot = 0.0;
+    std::vector<std::pair<uint32_t, size_t>> stack;
+    stack.emplace_back(0, 0);
+    while (!stack.empty()) {
+        auto& [id, childIdx] = stack.back();
+        const MapNode& n = nodes[id];
+        if (n.level < level && childIdx < n.children.size()) {
+            uint32_t child = n.children[childIdx++];
+            if (nodes[child].level <= level)
+                stack.emplace_back(child, 0);
+            continue;
+        }
+
+        Placement& p = placement[id];
+        p.visible = true;
+        const Placement* first = nullptr;
+        const Placement* last = nullptr;
+        for (uint32_t child : n.children) {
+            if (!placement[child].visible)
+                continue;
+            if (!first) first = &placement[child];
+            last = &placement[child];
+        }
+        if (first) {
+            p.breadth = (first->breadth + last->breadth) / 2.0;
+            p.spanBegin = first->spanBegin;
+            p.spanEnd = last->spanEnd;
+        } else {
+            p.breadth = p.spanBegin = p.spanEnd = nextSlot;
+            nextSlot += 1.0;
+        }
+        stack.pop_back();
+    }
+    return placement;
+}
+
+bool MapExporter::exportTiles(const CodeMap& map, const std::string& outputDir) const {
+    const auto& nodes = map.nodes();
+    if (nodes.empty()) {
+        std::cerr << "Erreur: carte vide, rien a exporter\n";
+        return false;
+    }
+
+    try {
+        fs::create_directories(fs::path(outputDir) / "tiles");
+    }
+    catch (const fs::filesystem_error& e) {
+        std::cerr << "FS error sur " << outputDir << " : " << e.what() << "\n";
+        return false;
+    }
+
+    std::ofstream manifest(fs::path(outputDir) / "manifest.json");
+    if (!manifest) {
+        std::cerr << "Erreur: impossible d'ecrire " << outputDir << "/manifest.json\n";
+        return false;
+    }
+    manifest << std::fixed << std::setprecision(1);
+    manifest << "{\"orientation\":\""
+        << (options_.orientation == MapOrientation::Vertical ? "vertical" : "horizontal")
+        << "\",\"tileSize\":" << options_.tileSize
+        << ",\"nodeSpacing\":" << options_.nodeSpacing
+        << ",\"levelSpacing\":" << options_.levelSpacing
+        << ",\"levels\":[";
+
+    for (int lvl = 0; lvl < kMapLevelCount; ++lvl) {
+        MapLevel level = static_cast<MapLevel>(lvl);
+        std::vector<Placement> placement = layoutLevel(map, level);
+
+        std::vector<double> xs(nodes.size()), ys(nodes.size());
+        std::map<TileKey, Tile> tiles;
+        double minX = 0.0, minY = 0.0, maxX = 0.0, maxY = 0.0;
+        size_t nodeCount = 0;
+
+        auto tileOf = [&](uint32_t id) {
+            return TileKey(static_cast<long long>(std::floor(xs[id] / options_.tileSize)),
+                           static_cast<long long>(std::floor(ys[id] / options_.tileSize)));
+        };
+
+        for (uint32_t id = 0; id < nodes.size(); ++id) {
+            if (!placement[id].visible)
+                continue;
+            toPosition(nodes[id], placement[id], xs[id], ys[id]);
+            if (nodeCount++ == 0) {
+                minX = maxX = xs[id];
+                minY = maxY = ys[id];
+            }
+            minX = std::min(minX, xs[id]); maxX = std::max(maxX, xs[id]);
+            minY = std::min(minY, ys[id]); maxY = std::max(maxY, ys[id]);
+            tiles[tileOf(id)].nodes.push_back(id);
+        }
+
+        // appels agreges entre les noeuds visibles a ce niveau
+        std::unordered_map<uint64_t, uint32_t> edgeCounts;
+        for (auto& [caller, callee] : map.calls()) {
+            uint32_t from = map.ancestorAt(caller, level);
+            uint32_t to = map.ancestorAt(callee, level);
+            if (from == to)
+                continue;
+            ++edgeCounts[(static_cast<uint64_t>(from) << 32) | to];
+        }
+        // l'arete est ecrite dans la tuile de chaque extremite : un appel vers un
+        // noeud a l'ecran reste visible quand l'appelant est hors champ
+        for (auto& [key, count] : edgeCounts) {
+            TileKey fromTile = tileOf(static_cast<uint32_t>(key >> 32));
+            TileKey toTile = tileOf(static_cast<uint32_t>(key & 0xffffffffu));
+            tiles[fromTile].edges.emplace_back(key, count);
+            if (toTile != fromTile)
+                tiles[toTile].edges.emplace_back(key, count);
+        }
+
+        fs::path levelDir = fs::path(outputDir) / "tiles" / std::to_string(lvl);
+        try {
+            fs::create_directories(levelDir);
+        }
+        catch (const fs::filesystem_error& e) {
+            std::cerr << "FS error sur " << levelDir << " : " << e.what() << "\n";
+            return false;
+        }
+
+        for (auto& [key, tile] : tiles) {
+            fs::path tilePath = levelDir / (std::to_string(key.first) + "_" + std::to_string(key.second) + ".json");
+            std::ofstream out(tilePath);
+            if (!out) {
+                std::cerr << "Erreur: impossible d'ecrire " << tilePath.string() << "\n";
+                return false;
+            }
+            out << std::fixed << std::setprecision(1);
+
+            out << "{\"nodes\":[";
+            for (size_t i = 0; i < tile.nodes.size(); ++i) {
+                uint32_t id = tile.nodes[i];
+                const MapNode& n = nodes[id];
+                const Placement& p = placement[id];
+                out << (i ? "," : "")
+                    << "{\"id\":" << id
+                    << ",\"parent\":" << (n.parent == CodeMap::npos ? -1LL : static_cast<long long>(n.parent))
+                    << ",\"kind\":\"" << toString(n.level)
+                    << "\",\"label\":\"" << jsonEscape(n.label)
+                    << "\",\"x\":" << xs[id] << ",\"y\":" << ys[id]
+                    << ",\"span\":[" << p.spanBegin * options_.nodeSpacing
+                    << "," << p.spanEnd * options_.nodeSpacing << "]"
+                    << ",\"weight\":" << n.weight << "}";
+            }
+            out << "],\"edges\":[";
+            for (size_t i = 0; i < tile.edges.size(); ++i) {
+                uint32_t from = static_cast<uint32_t>(tile.edges[i].first >> 32);
+                uint32_t to = static_cast<uint32_t>(tile.edges[i].first & 0xffffffffu);
+                out << (i ? "," : "")
+                    << "{\"from\":" << from << ",\"to\":" << to
+                    << ",\"x1\":" << xs[from] << ",\"y1\":" << ys[from]
+                    << ",\"x2\":" << xs[to] << ",\"y2\":" << ys[to]
+                    << ",\"count\":" << tile.edges[i].second << "}";
+            }
+            out << "]}\n";
+        }
+
+        manifest << (lvl ? "," : "")
+            << "{\"level\":" << lvl
+            << ",\"name\":\"" << toString(level)
+            << "\",\"nodeCount\":" << nodeCount
+            << ",\"edgeCount\":" << edgeCounts.size()
+            << ",\"bounds\":[" << minX << "," << minY << "," << maxX << "," << maxY << "]"
+            << ",\"tiles\":[";
+        bool firstTile = true;
+        for (auto& [key, tile] : tiles) {
+            manifest << (firstTile ? "" : ",") << "[" << key.first << "," << key.second << "]";
+            firstTile = false;
+        }
+        manifest << "]}";
+    }
+
+    manifest << "]}\n";
+    return true;
+}
@@ -0,0 +1,45 @@
+#ifndef MAPEXPORTER_HPP
+#define MAPEXPORTER_HPP
+
+#include <string>
+#include <vector>
+#include "CodeMap.hpp"
+
+namespace DragonEyes {
+
+    enum class MapOrientation { Vertical, Horizontal };
+
+    struct MapOptions {
+        MapOrientation orientation = MapOrientation::Vertical;
+        double nodeSpacing  = 40.0;   // ecart entre deux feuilles voisines
+        double levelSpacing = 200.0;  // ecart entre deux niveaux de la hierarchie
+        double tileSize     = 2048.0; // cote d'une tuile, en unites de layout
+    };
+
+    // Ecrit la carte sous forme de tuiles JSON par niveau de detail :
+    //   <dir>/manifest.json               niveaux, bornes et tuiles non vides
+    //   <dir>/tiles/<niveau>/<tx>_<ty>.json noeuds et appels agreges de la tuile
+    // Le visualiseur web ne charge que les tuiles a l'ecran.
+    class MapExporter {
+    public:
+        explicit MapExporter(const MapOptions& options = {});
+
+        bool exportTiles(const CodeMap& map, const std::string& outputDir) const;
+
+    private:
+        struct Placement {
+            bool visible = false;
+            double breadth = 0.0;   // position le long des feuilles
+            double spanBegin = 0.0; // etendue des feuilles couvertes
+            double spanEnd = 0.0;
+        };
+
+        MapOptions options_;
+
+        std::vector<Placement> layoutLevel(const CodeMap& map, MapLevel level) const;
+        void toPosition(const MapNode& n, const Placement& p, double& x, double& y) const;
+    };
+
+} // namespace DragonEyes
+
+#endif // !MAPEXPORTER_HPP
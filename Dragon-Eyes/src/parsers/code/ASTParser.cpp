@@ -1,5 +1,6 @@
 #include "ASTParser.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <iostream>
 
@@ -82,6 +83,10 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
                 p.access = AccessSpecifier::Public;
                 fn.parameters.push_back(std::move(p));
             }
+            // corps de la fonction : locales & appels
+            fn.isDefinition = clang_isCursorDefinition(c);
+            if (fn.isDefinition)
+                clang_visitChildren(c, bodyVisitor, &fn);
             f->functions.push_back(std::move(fn));
         }
         break;
@@ -111,26 +116,16 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
     }
 
     //--- Enumrations ---
-    case CXCursor_EnumDecl: {
-        // parcourir les constantes
-        clang_visitChildren(c, [](CXCursor cc, CXCursor, CXClientData) {
-            if (clang_getCursorKind(cc) == CXCursor_EnumConstantDecl) {
-                std::string label = toString(clang_getCursorSpelling(cc));
-                long long val = clang_getEnumConstantDeclValue(cc);
-                std::string value = std::to_string(val);
-                // Pour l'instant on affiche ; vous pouvez stocker ailleurs
-                std::cout << "    Enum constant: " << label << " = " << value << "\n";
-            }
-            return CXChildVisit_Continue;
-            }, nullptr);
+    case CXCursor_EnumDecl:
+        // les constantes ne sont pas encore stockees dans le modele
         break;
-    }
 
     //--- Dfinition d'une classe/struct ---
     case CXCursor_ClassDecl:
     case CXCursor_StructDecl: {
         CppClass cls;
         cls.name = toString(clang_getCursorSpelling(c));
+        cls.isDefinition = clang_isCursorDefinition(c);
         // nappes de base
         clang_visitChildren(c, [](CXCursor cc, CXCursor, CXClientData clientData) {
             auto* clsPtr = reinterpret_cast<CppClass*>(clientData);
@@ -166,6 +161,7 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
                 Function m;
                 m.name   = toString(clang_getCursorSpelling(cc));
                 m.access = acc;
+                m.isDefinition = clang_isCursorDefinition(cc);
                 int nargs = clang_Cursor_getNumArguments(cc);
                 for (int i = 0; i < nargs; ++i) {
                     CXCursor arg = clang_Cursor_getArgument(cc, i);
@@ -205,12 +201,19 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
             f->classes.begin(), f->classes.end(),
             [&](auto& cls){ return cls.name == clsName; }
         );
-        if (it == f->classes.end()) break;
+        // classe declaree dans un en-tete : on la cree pour garder les appels
+        if (it == f->classes.end()) {
+            CppClass external;
+            external.name = clsName;
+            f->classes.push_back(std::move(external));
+            it = std::prev(f->classes.end());
+        }
         CppClass& cls = *it;
 
         Function m;
         m.name   = toString(clang_getCursorSpelling(c));
         m.access = toAccessSpec(c);
+        m.isDefinition = true;
         int nargs = clang_Cursor_getNumArguments(c);
         for (int i = 0; i < nargs; ++i) {
             CXCursor arg = clang_Cursor_getArgument(c, i);
@@ -223,26 +226,7 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
             m.parameters.push_back(std::move(p));
         }
         // corps de la mthode : locales & appels
-        clang_visitChildren(c, [](CXCursor cc, CXCursor, CXClientData clientData) {
-            auto* mPtr = reinterpret_cast<Function*>(clientData);
-            CXCursorKind k2 = clang_getCursorKind(cc);
-            if (k2 == CXCursor_VarDecl) {
-                Variable v;
-                v.name   = toString(clang_getCursorSpelling(cc));
-                v.type   = toString(
-                    clang_getTypeSpelling(clang_getCursorType(cc))
-                );
-                v.access = AccessSpecifier::Private;
-                mPtr->localVariables.push_back(std::move(v));
-            } else if (k2 == CXCursor_CallExpr) {
-                std::string called = toString(
-                    clang_getCursorSpelling(cc)
-                );
-                if (!called.empty())
-                    mPtr->calledFunctions.push_back(called);
-            }
-            return CXChildVisit_Recurse;
-            }, &m);
+        clang_visitChildren(c, bodyVisitor, &m);
 
         // injection
         if (m.access == AccessSpecifier::Public)
@@ -261,6 +245,26 @@ CXChildVisitResult DragonEyes::ASTParser::visitor(CXCursor c, CXCursor parent, C
     return CXChildVisit_Recurse;
 }
 
+CXChildVisitResult DragonEyes::ASTParser::bodyVisitor(CXCursor c, CXCursor parent, CXClientData clientData) {
+    auto* fn = reinterpret_cast<Function*>(clientData);
+    CXCursorKind kind = clang_getCursorKind(c);
+    if (kind == CXCursor_VarDecl) {
+        Variable v;
+        v.name   = toString(clang_getCursorSpelling(c));
+        v.type   = toString(
+            clang_getTypeSpelling(clang_getCursorType(c))
+        );
+        v.access = AccessSpecifier::Private;
+        fn->localVariables.push_back(std::move(v));
+    } else if (kind == CXCursor_CallExpr) {
+        std::string called = toString(
+            clang_getCursorSpelling(c)
+        );
+        if (!called.empty())
+            fn->calledFunctions.push_back(called);
+    }
+    return CXChildVisit_Recurse;
+}
 
 std::string DragonEyes::ASTParser::toString(CXString s) {
     std::string str = clang_getCString(s);
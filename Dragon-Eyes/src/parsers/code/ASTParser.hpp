@@ -21,6 +21,7 @@ namespace DragonEyes {
 		std::vector<const char*> clangArgs_;
 
 		static CXChildVisitResult visitor(CXCursor c, CXCursor parent, CXClientData clientData);
+		static CXChildVisitResult bodyVisitor(CXCursor c, CXCursor parent, CXClientData clientData);
 
 		static std::string toString(CXString s);
 		static DragonEyes::AccessSpecifier toAccessSpec(CXCursor c);
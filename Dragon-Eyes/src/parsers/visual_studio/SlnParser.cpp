@@ -3,7 +3,6 @@
 #include <fstream>
 #include <regex>
 #include <filesystem>
-#include <iostream>
 
 namespace fs = std::filesystem;
 using namespace DragonEyes;
@@ -19,8 +18,6 @@ Solution SlnParser::parseSolution(const std::string& slnPath) {
     for (auto& [projName, relPath] : entries) {
         fs::path fullProjPath = slnDir / relPath;
 
-        std::cout << "parsed : " << projName << " " << relPath << "\t" << fullProjPath.string() << std::endl;
-
         Project proj = vcxParser.parseVcxproj(fullProjPath.string());
         proj.name = projName;
         sol.projects.push_back(std::move(proj));
@@ -0,0 +1,36 @@
+#ifndef JSON_HPP
+#define JSON_HPP
+
+#include <string>
+#include <cstdio>
+
+namespace DragonEyes {
+
+    // Echappe une chaine pour l'ecrire entre guillemets dans un fichier JSON.
+    inline std::string jsonEscape(const std::string& s) {
+        std::string out;
+        out.reserve(s.size() + 2);
+        for (unsigned char ch : s) {
+            switch (ch) {
+            case '"':  out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\n': out += "\\n";  break;
+            case '\r': out += "\\r";  break;
+            case '\t': out += "\\t";  break;
+            default:
+                if (ch < 0x20) {
+                    char buf[7];
+                    std::snprintf(buf, sizeof(buf), "\\u%04x", ch);
+                    out += buf;
+                } else {
+                    out += static_cast<char>(ch);
+                }
+                break;
+            }
+        }
+        return out;
+    }
+
+} // namespace DragonEyes
+
+#endif // !JSON_HPP
@@ -0,0 +1,21 @@
+#ifndef PATHS_HPP
+#define PATHS_HPP
+
+#include <string>
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+
+namespace DragonEyes {
+
+    // Vrai pour un fichier compile seul (.c, .cc, .cpp, .cxx) ; faux pour un en-tete.
+    inline bool isTranslationUnit(const std::string& path) {
+        std::string ext = std::filesystem::path(path).extension().string();
+        std::transform(ext.begin(), ext.end(), ext.begin(),
+            [](unsigned char ch) { return static_cast<char>(std::tolower(ch)); });
+        return ext == ".c" || ext == ".cc" || ext == ".cpp" || ext == ".cxx";
+    }
+
+} // namespace DragonEyes
+
+#endif // !PATHS_HPP